@@ -7,19 +7,67 @@
 //
 
 #include "Memory.hxx"
+#include <cstdint>
 
 #if defined _WIN32 || defined _WIN64
-Module::Module(const char* path) : module(static_cast<void*>(LoadLibraryA(path))) {}
-Module::Module(const wchar_t* path) : module(static_cast<void*>(LoadLibraryW(path))) {}
+Module::Module(const char* path, bool /*ResolveNow*/) : module(static_cast<void*>(LoadLibraryA(path))) {}
+Module::Module(const wchar_t* path, bool /*ResolveNow*/) : module(static_cast<void*>(LoadLibraryW(path))) {}
 
-Module::~Module() {FreeLibrary(static_cast<HMODULE>(module));}
+Module::~Module() {if (module) FreeLibrary(static_cast<HMODULE>(module));}
 #else
-Module::Module(const char* path) : module(dlopen(path, RTLD_LAZY | RTLD_GLOBAL)) {}
-Module::Module(const wchar_t* path) : module(nullptr)
+namespace
 {
-    std::string utf8 = std::wstring_convert<std::codecvt_utf8<wchar_t>>().to_bytes(path);
-    module = dlopen(utf8.c_str(), RTLD_LAZY | RTLD_GLOBAL);
+    std::string ToUTF8(const wchar_t* str)
+    {
+        std::string result;
+        for (; *str; ++str)
+        {
+            std::uint32_t c = static_cast<std::uint32_t>(*str);
+            if (sizeof(wchar_t) == 2 && c >= 0xD800 && c <= 0xDBFF)
+            {
+                std::uint32_t low = static_cast<std::uint32_t>(str[1]);
+                if (low < 0xDC00 || low > 0xDFFF)
+                {
+                    throw std::range_error("ToUTF8: unpaired surrogate");
+                }
+
+                c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                ++str;
+            }
+            else if ((c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF)
+            {
+                throw std::range_error("ToUTF8: invalid code point");
+            }
+
+            if (c < 0x80)
+            {
+                result += static_cast<char>(c);
+            }
+            else if (c < 0x800)
+            {
+                result += static_cast<char>(0xC0 | (c >> 6));
+                result += static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else if (c < 0x10000)
+            {
+                result += static_cast<char>(0xE0 | (c >> 12));
+                result += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else
+            {
+                result += static_cast<char>(0xF0 | (c >> 18));
+                result += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+                result += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (c & 0x3F));
+            }
+        }
+        return result;
+    }
 }
 
-Module::~Module() {dlclose(module);}
+Module::Module(const char* path, bool ResolveNow) : module(dlopen(path, (ResolveNow ? RTLD_NOW : RTLD_LAZY) | RTLD_GLOBAL)) {}
+Module::Module(const wchar_t* path, bool ResolveNow) : Module(ToUTF8(path).c_str(), ResolveNow) {}
+
+Module::~Module() {if (module) dlclose(module);}
 #endif
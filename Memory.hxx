@@ -18,8 +18,18 @@
 
 #include <string>
 #include <stdexcept>
-#include <locale>
-#include <codecvt>
+#include <utility>
+#include <type_traits>
+
+#if defined _WIN32 || defined _WIN64
+#define MODULE_CALLCONV __stdcall
+#else
+#define MODULE_CALLCONV
+#endif
+
+
+template<typename T>
+class Symbol;
 
 /********************************************//**
  * @brief Wraps the loading of modules/shared-libraries
@@ -29,23 +39,30 @@ class Module
 private:
     void* module;
 
+    template<typename T>
+    friend class Symbol;
+
+    void* Lookup(const char* Name) const;
+
 public:
     /********************************************//**
      * @brief Loads a module/shared-library.
      *
      * @param path const char* Path to the module to be loaded.
+     * @param ResolveNow bool - Resolve all undefined symbols at load time (RTLD_NOW) instead of on first use.
      *
      ***********************************************/
-    Module(const char* path);
+    Module(const char* path, bool ResolveNow = false);
 
 
     /********************************************//**
      * @brief Loads a module/shared-library.
      *
      * @param path const wchar_t* Path to the module to be loaded.
+     * @param ResolveNow bool - Resolve all undefined symbols at load time (RTLD_NOW) instead of on first use.
      *
      ***********************************************/
-    Module(const wchar_t* path);
+    Module(const wchar_t* path, bool ResolveNow = false);
 
 
     /********************************************//**
@@ -100,6 +117,17 @@ public:
     bool IsLoaded() const {return module != nullptr;}
 
 
+    /********************************************//**
+     * @brief Retrieves the address of a function within the underlying module.
+     *
+     * @param FunctionName const char* - Name of the function whose address is to be retrieved.
+     * @return T - Casts the address to type T and returns the result.
+     *
+     ***********************************************/
+    template<typename T>
+    T AddressOf(const char* FunctionName) const;
+
+
     /********************************************//**
      * @brief Retrieves the address of a function within the underlying module.
      *
@@ -108,7 +136,19 @@ public:
      *
      ***********************************************/
     template<typename T>
-    T AddressOf(const std::string &FunctionName);
+    T AddressOf(const std::string &FunctionName) const {return AddressOf<T>(FunctionName.c_str());}
+
+
+    /********************************************//**
+     * @brief Retrieves the address of a function within the underlying module.
+     *
+     * @param FunctionDefinition T& - Reference to a pointer that the address will be stored in.
+     * @param FunctionName const char* - Name of the function whose address is to be retrieved.
+     * @return bool - True if the function exists in the module, false otherwise.
+     *
+     ***********************************************/
+    template<typename T>
+    bool AddressOf(T &FunctionDefinition, const char* FunctionName) const;
 
 
     /********************************************//**
@@ -120,65 +160,166 @@ public:
      *
      ***********************************************/
     template<typename T>
-    bool AddressOf(T &FunctionDefinition, const std::string &FunctionName);
+    bool AddressOf(T &FunctionDefinition, const std::string &FunctionName) const {return AddressOf(FunctionDefinition, FunctionName.c_str());}
 
 
     /********************************************//**
-     * @brief Calls a function via pointer and passes the specified arguments to it.
+     * @brief Resolves a batch of symbols in one go, typically right after loading.
      *
-     * @param func void* - Address of the function to be called.
-     * @param args Args... - Arguments to pass to the function pointer.
-     * @return void
+     * @param symbol Symbol<T>& - Symbol to be resolved.
+     * @param Name const char* - Name of the symbol within the module.
+     * @param rest Rest&&... - Further (Symbol, Name) pairs.
+     * @return bool - True if every symbol was found, false otherwise. All symbols are attempted regardless.
+     *
+     * Usage: module.Resolve(OnMessage, "OnMessage", OnClose, "OnClose");
+     *
+     ***********************************************/
+    template<typename T, typename... Rest>
+    bool Resolve(Symbol<T> &symbol, const char* Name, Rest&&... rest) const;
+
+
+    /********************************************//**
+     * @brief Terminates a batch resolution.
      *
-     * Uses the __stdcall convention!
+     * @return bool - Always true.
      *
      ***********************************************/
-    template<typename... Args>
-    void Call(void* func, Args... args);
+    bool Resolve() const {return true;}
 
 
     /********************************************//**
      * @brief Calls a function via pointer, passes the specified arguments to it and returns the result of the function call.
      *
      * @param func void* - Address of the function to be called.
-     * @param args Args... - Arguments to pass to the function pointer.
-     * @return R - Result of the function call.
+     * @param args Args&&... - Arguments to pass to the function pointer.
+     * @return R - Result of the function call (void by default).
      *
-     * Uses the __stdcall convention!
+     * Uses the __stdcall convention on Windows! The function is assumed to take its parameters by value.
+     * Prefer Symbol<R(Args...)> when calling the same function repeatedly.
      *
      ***********************************************/
-    template<typename R, typename... Args>
-    R Call(void* func, Args... args);
+    template<typename R = void, typename... Args>
+    static R Call(void* func, Args&&... args);
 };
 
 
-template<typename T>
-T Module::AddressOf(const std::string &Name)
+/********************************************//**
+ * @brief A typed handle to a function within a module.
+ *
+ * Resolved once (on construction or via Module::Resolve) and afterwards
+ * called directly through the stored pointer; no lookup happens per call.
+ * The handle is only valid for as long as the module it came from stays loaded.
+ *
+ * Uses the __stdcall convention on Windows!
+ *
+ ***********************************************/
+template<typename R, typename... Args>
+class Symbol<R(Args...)>
+{
+public:
+    typedef R (MODULE_CALLCONV *pointer)(Args...);
+
+private:
+    pointer function;
+
+public:
+    /********************************************//**
+     * @brief Constructs an unresolved symbol.
+     ***********************************************/
+    Symbol() : function(nullptr) {}
+
+
+    /********************************************//**
+     * @brief Resolves a symbol from a module.
+     *
+     * @param module const Module& - Module containing the symbol.
+     * @param Name const char* - Name of the symbol.
+     *
+     * Throws std::runtime_error if the symbol cannot be found.
+     *
+     ***********************************************/
+    Symbol(const Module &module, const char* Name) : function(module.AddressOf<pointer>(Name)) {}
+
+
+    /********************************************//**
+     * @brief Resolves this symbol from a module.
+     *
+     * @param module const Module& - Module containing the symbol.
+     * @param Name const char* - Name of the symbol.
+     * @return bool - True if the symbol was found, false otherwise.
+     *
+     ***********************************************/
+    bool Resolve(const Module &module, const char* Name) {return (function = reinterpret_cast<pointer>(module.Lookup(Name))) != nullptr;}
+
+
+    /********************************************//**
+     * @brief When this class is casted to a bool.
+     *
+     * @return bool - Boolean indicating whether the symbol was resolved.
+     *
+     ***********************************************/
+    explicit operator bool() const {return function != nullptr;}
+
+
+    /********************************************//**
+     * @brief Returns the underlying function pointer.
+     *
+     * @return pointer - Address of the resolved function.
+     *
+     ***********************************************/
+    pointer get() const {return function;}
+
+
+    /********************************************//**
+     * @brief Calls the resolved function.
+     *
+     * @param args Ts&&... - Arguments forwarded to the function.
+     * @return R - Result of the function call.
+     *
+     ***********************************************/
+    template<typename... Ts>
+    R operator()(Ts&&... args) const {return function(std::forward<Ts>(args)...);}
+};
+
+
+inline void* Module::Lookup(const char* Name) const
 {
+    if (!module)
+    {
+        return nullptr; //dlsym treats a null handle as RTLD_DEFAULT.
+    }
+
     #if defined _WIN32 || defined _WIN64
-    T Result = reinterpret_cast<T>(GetProcAddress(static_cast<HMODULE>(module), Name.c_str()));
+    return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(module), Name));
     #else
-    T Result = reinterpret_cast<T>(dlsym(module, Name.c_str()));
+    return dlsym(module, Name);
     #endif
+}
+
+template<typename T>
+T Module::AddressOf(const char* Name) const
+{
+    T Result = reinterpret_cast<T>(Lookup(Name));
     return Result ? Result : throw std::runtime_error(Name);
 }
 
 template<typename T>
-bool Module::AddressOf(T &Definition, const std::string &Name)
+bool Module::AddressOf(T &Definition, const char* Name) const
 {
     return (Definition = AddressOf<T>(Name));
 }
 
-template<typename... Args>
-void Module::Call(void* func, Args... args)
+template<typename T, typename... Rest>
+bool Module::Resolve(Symbol<T> &symbol, const char* Name, Rest&&... rest) const
 {
-    return reinterpret_cast<void (__stdcall *)(Args...)>(func)(std::forward<Args>(args)...);
+    bool Result = symbol.Resolve(*this, Name);
+    return Resolve(std::forward<Rest>(rest)...) && Result;
 }
 
 template<typename R, typename... Args>
-R Module::Call(void* func, Args... args)
+R Module::Call(void* func, Args&&... args)
 {
-    return reinterpret_cast<R(__stdcall *)(Args...)>(func)(std::forward<Args>(args)...);
+    return reinterpret_cast<R (MODULE_CALLCONV *)(typename std::decay<Args>::type...)>(func)(std::forward<Args>(args)...);
 }
 
 #endif // MEMORY_HXX_INCLUDED